@@ -0,0 +1,272 @@
+/*
+   Copyright (c) 2020 Alex Zhondin <lexxmark.dev@gmail.com>
+
+   Licensed under the Apache License, Version 2.0 (the "License");
+   you may not use this file except in compliance with the License.
+   You may obtain a copy of the License at
+
+	   http://www.apache.org/licenses/LICENSE-2.0
+
+   Unless required by applicable law or agreed to in writing, software
+   distributed under the License is distributed on an "AS IS" BASIS,
+   WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+   See the License for the specific language governing permissions and
+   limitations under the License.
+*/
+
+#pragma once
+
+#ifndef STPL_RELOADABLE_STRING_TEMPLATE_H
+#define STPL_RELOADABLE_STRING_TEMPLATE_H
+
+#include "string_template.h"
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace stpl
+{
+	// Template loaded from a file that can be reloaded while other threads are rendering it.
+	// Readers never take a lock: they register in the current epoch and render the published version.
+	// Writers (reload) parse the new version aside, publish it and wait for readers of the old one to finish.
+	// File content is used as is (bytes without any decoding), so only char based templates are supported.
+	template <class StringTemplate = string_template>
+	class basic_reloadable_string_template
+	{
+		static_assert(std::is_same_v<typename StringTemplate::char_t, char>, "file content is read as bytes");
+
+	public:
+		using string_template_t = StringTemplate;
+		using char_t = typename StringTemplate::char_t;
+		using string_view_t = typename StringTemplate::string_view_t;
+		using string_t = typename StringTemplate::string_t;
+		using basic_ostream_t = typename StringTemplate::basic_ostream_t;
+		using regex_t = typename StringTemplate::regex_t;
+		using path_t = std::filesystem::path;
+		using file_time_t = std::filesystem::file_time_type;
+
+		// called for every freshly parsed template before it is published (to set arguments)
+		using prepare_t = std::function<void(string_template_t&)>;
+
+		explicit basic_reloadable_string_template(path_t path, prepare_t prepare = {})
+			: basic_reloadable_string_template(std::move(path), StringTemplate::default_arg_regex, std::move(prepare))
+		{
+		}
+
+		basic_reloadable_string_template(path_t path, string_view_t arg_regex, prepare_t prepare = {})
+			: basic_reloadable_string_template(std::move(path), regex_t(arg_regex.data(), arg_regex.length()), std::move(prepare))
+		{
+		}
+
+		// throws std::filesystem::filesystem_error if the file cannot be read
+		basic_reloadable_string_template(path_t path, regex_t arg_regex, prepare_t prepare = {})
+			: m_path(std::move(path)),
+			m_arg_regex(std::move(arg_regex)),
+			m_prepare(std::move(prepare))
+		{
+			std::error_code ec;
+			auto first = load(m_write_time, ec);
+			if (!first)
+				throw std::filesystem::filesystem_error("cannot load string template", m_path, ec);
+
+			m_current.store(first.release());
+		}
+
+		~basic_reloadable_string_template()
+		{
+			delete m_current.load();
+		}
+
+		basic_reloadable_string_template(const basic_reloadable_string_template&) = delete;
+		basic_reloadable_string_template& operator=(const basic_reloadable_string_template&) = delete;
+
+		const path_t& path() const noexcept { return m_path; }
+
+		// reads and parses the file, then publishes the new version
+		// returns false (and keeps the current version) if the file cannot be read
+		bool reload()
+		{
+			return reload_impl(false);
+		}
+
+		// same as reload but does nothing if the file write time hasn't changed since the last reload
+		bool reload_if_changed()
+		{
+			return reload_impl(true);
+		}
+
+		// invokes func with the currently published template
+		// the version stays alive until func returns even if reload happens meanwhile
+		// func must not call reload/reload_if_changed of this object: reload would wait for func forever
+		template <class Func>
+		decltype(auto) read(Func&& func) const
+		{
+			read_guard guard(*this);
+			return std::invoke(std::forward<Func>(func), std::as_const(guard.get()));
+		}
+
+		template <class Visitor>
+		void render_to(Visitor&& vis) const
+		{
+			read([&vis](const string_template_t& st) { st.render_to(std::forward<Visitor>(vis)); });
+		}
+
+		void render(string_t& result) const
+		{
+			read([&result](const string_template_t& st) { st.render(result); });
+		}
+
+		string_t render() const
+		{
+			string_t result;
+			render(result);
+			return result;
+		}
+
+		void render(basic_ostream_t& out) const
+		{
+			read([&out](const string_template_t& st) { st.render(out); });
+		}
+
+	private:
+		// template keeps string views to the source, so they live together
+		struct snapshot_t
+		{
+			string_t source;
+			string_template_t templ;
+		};
+
+		class read_guard
+		{
+		public:
+			explicit read_guard(const basic_reloadable_string_template& owner) noexcept
+			{
+				// register in the current epoch, retry if the epoch was changed meanwhile
+				for (;;)
+				{
+					auto epoch = owner.m_epoch.load();
+					m_readers = &owner.m_readers[epoch & 1].value;
+					m_readers->fetch_add(1);
+					if (owner.m_epoch.load() == epoch)
+						break;
+					m_readers->fetch_sub(1);
+				}
+
+				m_snapshot = owner.m_current.load();
+			}
+
+			~read_guard()
+			{
+				m_readers->fetch_sub(1);
+			}
+
+			read_guard(const read_guard&) = delete;
+			read_guard& operator=(const read_guard&) = delete;
+
+			const string_template_t& get() const noexcept { return m_snapshot->templ; }
+
+		private:
+			std::atomic<size_t>* m_readers = nullptr;
+			const snapshot_t* m_snapshot = nullptr;
+		};
+
+		// reads and parses the file off the render path
+		// returns nullptr if the file cannot be read completely (e.g. it is being written right now)
+		std::unique_ptr<snapshot_t> load(file_time_t& write_time, std::error_code& ec) const
+		{
+			write_time = std::filesystem::last_write_time(m_path, ec);
+			if (ec)
+				return nullptr;
+
+			auto size = std::filesystem::file_size(m_path, ec);
+			if (ec)
+				return nullptr;
+
+			auto next = std::make_unique<snapshot_t>();
+			next->source.resize(static_cast<size_t>(size));
+
+			std::ifstream in(m_path, std::ios::binary);
+			if (!in.read(next->source.data(), next->source.size()) || in.peek() != std::ifstream::traits_type::eof())
+			{
+				ec = std::make_error_code(std::errc::io_error);
+				return nullptr;
+			}
+
+			next->templ.parse_template(next->source, m_arg_regex);
+			if (m_prepare)
+				m_prepare(next->templ);
+
+			return next;
+		}
+
+		bool reload_impl(bool only_if_changed)
+		{
+			std::lock_guard<std::mutex> lock(m_writer_mutex);
+
+			std::error_code ec;
+			if (only_if_changed)
+			{
+				auto write_time = std::filesystem::last_write_time(m_path, ec);
+				if (ec || write_time == m_write_time)
+					return false;
+			}
+
+			file_time_t write_time;
+			auto next = load(write_time, ec);
+			if (!next)
+				return false;
+
+			m_write_time = write_time;
+			publish(next.release());
+			return true;
+		}
+
+		void publish(const snapshot_t* next)
+		{
+			const snapshot_t* old = m_current.exchange(next);
+
+			// start a new epoch: new readers see the new version only
+			auto epoch = m_epoch.load();
+			m_epoch.store(epoch + 1);
+
+			// wait until readers of the previous epoch finish with the old version
+			while (m_readers[epoch & 1].value.load() != 0)
+				std::this_thread::yield();
+
+			delete old;
+		}
+
+		path_t m_path;
+		regex_t m_arg_regex;
+		prepare_t m_prepare;
+
+		// writer side state
+		std::mutex m_writer_mutex;
+		file_time_t m_write_time = file_time_t::min();
+
+		// reader side state
+		// readers only load m_current and m_epoch but modify reader counters on every render,
+		// so counters live on their own cache lines to not slow down each other and the loads
+		constexpr static inline size_t cache_line_size = 64;
+
+		struct alignas(cache_line_size) readers_counter_t
+		{
+			std::atomic<size_t> value{ 0 };
+		};
+
+		alignas(cache_line_size) std::atomic<const snapshot_t*> m_current{ nullptr };
+		std::atomic<unsigned> m_epoch{ 0 };
+		mutable readers_counter_t m_readers[2];
+	};
+
+	using reloadable_string_template = basic_reloadable_string_template<string_template>;
+
+} // end namespace stpl
+
+#endif //STPL_RELOADABLE_STRING_TEMPLATE_H
@@ -89,6 +89,7 @@ namespace stpl
 		using args_map_t = typename Traits::template args_map_t<string_view_t, arg_store_value_t>;
 		using part_t = std::variant<string_view_t, const arg_store_value_t*>;
 		using parts_vector_t = typename Traits::template parts_vector_t<part_t>;
+		using literals_vector_t = typename Traits::template parts_vector_t<char_t>;
 
 		using regex_t = std::basic_regex<char_t>;
 		using match_const_it_t = typename string_view_t::const_iterator;
@@ -102,12 +103,14 @@ namespace stpl
 
 		basic_string_template(basic_string_template&& other) noexcept
 			: m_args(std::move(other.m_args)),
-			m_parts(std::move(other.m_parts))
+			m_parts(std::move(other.m_parts)),
+			m_literals(std::move(other.m_literals))
 		{}
 		basic_string_template& operator=(basic_string_template&& other) noexcept
 		{
 			m_args = std::move(other.m_args);
 			m_parts = std::move(other.m_parts);
+			m_literals = std::move(other.m_literals);
 			return *this;
 		}
 
@@ -116,14 +119,16 @@ namespace stpl
 
 		basic_string_template(const typename args_map_t::allocator_type& a_alloc, const typename parts_vector_t::allocator_type& p_alloc)
 			: m_args(a_alloc),
-			m_parts(p_alloc)
+			m_parts(p_alloc),
+			m_literals(p_alloc)
 		{
 		}
 
 		template <class Alloc>
 		explicit basic_string_template(const Alloc& alloc)
 			: m_args(alloc),
-			m_parts(alloc)
+			m_parts(alloc),
+			m_literals(alloc)
 		{
 		}
 
@@ -176,6 +181,7 @@ namespace stpl
 		void parse_template(string_view_t str_template, const regex_t& arg_regex, match_results_t& match)
 		{
 			m_parts.clear();
+			m_literals.clear();
 
 			if constexpr (clear_args_on_parse_template)
 				m_args.clear();
@@ -303,12 +309,44 @@ namespace stpl
 		{
 			m_parts.clear();
 			m_args.clear();
+			m_literals.clear();
 		}
 
 		void swap(basic_string_template& other) noexcept
 		{
 			std::swap(m_args, other.m_args);
 			std::swap(m_parts, other.m_parts);
+			std::swap(m_literals, other.m_literals);
+		}
+
+		// returns a new template where arguments accepted by the visitor are replaced with their values
+		// and merged with neighbouring pieces of template into single parts
+		// visitor has the same signature as in set_args_if
+		// callable argument values are invoked once here
+		// the new template refers to the same template string as this one
+		template<typename Visitor>
+		basic_string_template specialize_if(Visitor&& vis) const
+		{
+			args_map_t fixed(m_args.get_allocator());
+			for (const auto& [k, v] : m_args)
+			{
+				arg_value_t value;
+				if (std::invoke(std::forward<Visitor>(vis), k, value))
+					fixed.try_emplace(k, std::in_place_index<1>, std::move(value));
+			}
+			return specialize_args(fixed);
+		}
+
+		// returns a new template where all initialized arguments are folded (see specialize_if)
+		basic_string_template specialize() const
+		{
+			args_map_t fixed(m_args.get_allocator());
+			for (const auto& [k, v] : m_args)
+			{
+				if (v.index() == 1)
+					fixed.try_emplace(k, v);
+			}
+			return specialize_args(fixed);
 		}
 
 		template <class Visitor>
@@ -320,23 +358,8 @@ namespace stpl
 				if (p.index() == 0)
 					std::invoke(std::forward<Visitor>(vis), std::get<0>(p));
 				else
-				{
 					// part is argument value or piece of template
-					const auto& arg_value = *std::get<1>(p);
-					// if argument value uninitialized -> get piece of template
-					if (arg_value.index() == 0)
-						std::invoke(std::forward<Visitor>(vis), std::get<0>(arg_value));
-					else
-					{
-						// argument value is initialized
-						// if argument value is callable -> invoke with no arguments
-						if constexpr (std::is_invocable_v<arg_value_t>)
-							std::invoke(std::forward<Visitor>(vis), std::get<1>(arg_value)());
-						else
-							// argument value is orginary value
-							std::invoke(std::forward<Visitor>(vis), std::get<1>(arg_value));
-					}
-				}
+					render_arg_to(*std::get<1>(p), std::forward<Visitor>(vis));
 			}
 		}
 
@@ -358,8 +381,93 @@ namespace stpl
 		}
 
 	private:
+		template <class Visitor>
+		static void render_arg_to(const arg_store_value_t& arg_value, Visitor&& vis)
+		{
+			// if argument value uninitialized -> get piece of template
+			if (arg_value.index() == 0)
+				std::invoke(std::forward<Visitor>(vis), std::get<0>(arg_value));
+			else
+			{
+				// argument value is initialized
+				// if argument value is callable -> invoke with no arguments
+				if constexpr (std::is_invocable_v<arg_value_t>)
+					std::invoke(std::forward<Visitor>(vis), std::get<1>(arg_value)());
+				else
+					// argument value is orginary value
+					std::invoke(std::forward<Visitor>(vis), std::get<1>(arg_value));
+			}
+		}
+
+		basic_string_template specialize_args(const args_map_t& fixed) const
+		{
+			basic_string_template result(m_args.get_allocator(), m_parts.get_allocator());
+
+			// maps argument values of this template to fixed values or to argument values of the result
+			using values_map_t = typename Traits::template args_map_t<const arg_store_value_t*, std::pair<const arg_store_value_t*, bool>>;
+			values_map_t values(m_args.get_allocator());
+			for (const auto& [k, v] : m_args)
+			{
+				if (auto it = fixed.find(k); it != fixed.end())
+					values.emplace(&v, std::make_pair(&it->second, true));
+				else
+				{
+					auto res = result.m_args.try_emplace(k, v);
+					values.emplace(&v, std::make_pair(&res.first->second, false));
+				}
+			}
+
+			// collect consecutive pieces of template and fixed values to m_literals
+			auto append = [&result](const auto& piece) {
+				string_view_t str(piece);
+				result.m_literals.insert(result.m_literals.end(), str.begin(), str.end());
+			};
+
+			// m_literals may grow, so merged parts are empty placeholders until it is complete
+			typename Traits::template parts_vector_t<size_t> run_lengths(m_parts.get_allocator());
+			size_t run_begin = 0;
+			auto close_run = [&result, &run_lengths, &run_begin]() {
+				if (auto length = result.m_literals.size() - run_begin; length != 0)
+				{
+					run_lengths.push_back(length);
+					result.m_parts.push_back(string_view_t());
+				}
+				run_begin = result.m_literals.size();
+			};
+
+			for (const auto& p : m_parts)
+			{
+				if (p.index() == 0)
+					append(std::get<0>(p));
+				else if (const auto& [value, is_fixed] = values.at(std::get<1>(p)); is_fixed)
+					render_arg_to(*value, append);
+				else
+				{
+					close_run();
+					result.m_parts.push_back(value);
+				}
+			}
+			close_run();
+
+			// m_literals is complete -> point merged parts to it
+			size_t offset = 0;
+			auto length_it = run_lengths.begin();
+			for (auto& p : result.m_parts)
+			{
+				if (p.index() == 0)
+				{
+					p = string_view_t(result.m_literals.data() + offset, *length_it);
+					offset += *length_it++;
+				}
+			}
+
+			return result;
+		}
+
 		args_map_t m_args;
 		parts_vector_t m_parts;
+		// storage for template pieces merged by specialize
+		literals_vector_t m_literals;
 	};
 
 	using string_template = basic_string_template<string_template_traits<char>>;
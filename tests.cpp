@@ -15,11 +15,15 @@
 */
 
 #include "string_template.h"
+#include "reloadable_string_template.h"
 #include <iostream>
 #include <memory_resource>
 #include <array>
 #include <sstream>
 #include <functional>
+#include <fstream>
+#include <filesystem>
+#include <thread>
 
 #define EXPECT_M(a, b, s, l) do { if ((a) != (b)) throw std::logic_error(std::string(s) + " At line " + std::to_string(l)); } while(false)
 #define EXPECT(a, b) EXPECT_M(a, b, "Test failed.", __LINE__)
@@ -257,6 +261,125 @@ int main()
             EXPECT(templates[0].render(), "Hello World!");
             EXPECT(templates[1].render(), "Bye Space!");
         }
+        // specialize
+        {
+            auto st = make_template("Hello {{name1}}! Hello {{name2}}! Hello {{name1}}!");
+            st.set_arg("name1", "World");
+            auto sst = st.specialize();
+            EXPECT(sst.args().size(), size_t(1));
+            EXPECT(sst.render(), "Hello World! Hello {{name2}}! Hello World!");
+
+            sst.set_arg("name2", "Space");
+            EXPECT(sst.render(), "Hello World! Hello Space! Hello World!");
+            EXPECT(st.render(), "Hello World! Hello {{name2}}! Hello World!");
+        }
+
+        // specialize using visitor
+        {
+            auto st = make_template("{{host}}: {{name}}{{product}}!");
+            auto sst = st.specialize_if([](auto& name, auto& value) {
+                if (name == "name")
+                    return false;
+                value = name == "host" ? "localhost" : " from stpl";
+                return true;
+            });
+            EXPECT(sst.args().size(), size_t(1));
+
+            // move keeps merged parts valid
+            std::vector<string_template> templates;
+            templates.push_back(std::move(sst));
+            templates[0].set_arg("name", "Hello");
+            EXPECT(templates[0].render(), "localhost: Hello from stpl!");
+
+            // specialize specialized template
+            auto ssst = templates[0].specialize();
+            EXPECT(ssst.args().empty(), true);
+            EXPECT(ssst.render(), "localhost: Hello from stpl!");
+        }
+
+        // std::pmr specialize
+        {
+            std::array<char, 2048> buff;
+            std::pmr::monotonic_buffer_resource mem(buff.data(), buff.size(), std::pmr::null_memory_resource());
+
+            auto st = make_template<pmr::string_template>("Hello {{name1}}! Hello {{name2}}!", dar(), &mem);
+            st.set_arg("name2", "Space");
+
+            // temporary containers of specialize use the template allocator, not the default resource
+            auto default_resource = std::pmr::set_default_resource(std::pmr::null_memory_resource());
+            auto sst = st.specialize();
+            std::pmr::set_default_resource(default_resource);
+
+            sst.set_arg("name1", "World");
+            EXPECT(sst.render(), "Hello World! Hello Space!");
+        }
+
+        // reloadable template
+        {
+            auto path = std::filesystem::temp_directory_path() / "stpl_reloadable_test.txt";
+            std::ofstream(path) << "Hello {{name}}!";
+
+            reloadable_string_template st(path, [](string_template& t) { t.set_arg("name", "World"); });
+            EXPECT(st.render(), "Hello World!");
+            EXPECT(st.reload_if_changed(), false);
+
+            std::ofstream(path) << "Bye {{name}}!";
+            std::filesystem::last_write_time(path, std::filesystem::last_write_time(path) + std::chrono::seconds(1));
+            EXPECT(st.reload_if_changed(), true);
+            EXPECT(st.render(), "Bye World!");
+
+            // render while reloading
+            std::atomic<bool> stop = false;
+            std::atomic<bool> failed = false;
+            std::thread reader([&] {
+                while (!stop)
+                {
+                    auto r = st.render();
+                    if (r != "Hello World!" && r != "Bye World!")
+                        failed = true;
+                }
+            });
+
+            for (int i = 0; i < 100; ++i)
+            {
+                std::ofstream(path) << (i % 2 ? "Bye {{name}}!" : "Hello {{name}}!");
+                st.reload();
+            }
+
+            stop = true;
+            reader.join();
+            EXPECT(failed.load(), false);
+
+            // file content is used as is
+            std::ofstream(path, std::ios::binary) << "Caf\xC3\xA9 {{name}}!";
+            EXPECT(st.reload(), true);
+            EXPECT(st.render(), "Caf\xC3\xA9 World!");
+
+            // bad reload keeps the old version
+            std::filesystem::remove(path);
+            EXPECT(st.reload(), false);
+            EXPECT(st.render(), "Caf\xC3\xA9 World!");
+
+            std::filesystem::create_directory(path);
+            EXPECT(st.reload(), false);
+            EXPECT(st.render(), "Caf\xC3\xA9 World!");
+            std::filesystem::remove(path);
+        }
+
+        // reloadable template without file
+        {
+            auto path = std::filesystem::temp_directory_path() / "stpl_reloadable_missing.txt";
+            bool thrown = false;
+            try
+            {
+                reloadable_string_template st(path);
+            }
+            catch (const std::filesystem::filesystem_error&)
+            {
+                thrown = true;
+            }
+            EXPECT(thrown, true);
+        }
     }
     catch (const std::logic_error& e)
     {